@@ -0,0 +1,145 @@
+/*
+********************************************************************************
+* FILE        : arena.h
+* DESCRIPTION : Header file for the region allocator of a model load
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __ARENA_H
+#define __ARENA_H
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the size of a block that small items are handed out from in turn */
+#define ARENABLOCKSIZE	65536UL
+
+/*
+ * an item of this size or more is given a block of its own, so that it
+ * can be shrunk or released before the rest of the arena
+ */
+#define ARENALARGE	16384UL
+
+/* every item starts on a multiple of this many bytes */
+#define ARENAALIGN	16UL
+
+
+
+/*
+ *******************************************************************************
+ *                      	STRUCTURES				       *
+ *******************************************************************************
+*/
+
+
+/* one block of an arena, its items following the header */
+struct arenablock {
+   struct arenablock *next;   /* the block made before this one        */
+   unsigned long     size,    /* the bytes of the block after the header */
+                     used;    /* the bytes handed out so far           */
+   int               single;  /* 1 if the block holds one large item   */
+};
+
+
+/* a region of memory, all of it released together */
+struct arena {
+   struct arenablock *blocks,    /* the newest block, and the rest behind */
+                     *current;   /* the block small items come from       */
+   unsigned long     numblocks,  /* the blocks held                       */
+                     inuse,      /* the bytes of all the blocks held      */
+                     highwater;  /* the most bytes ever held at once      */
+};
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+struct arena * Createarena (void);
+/* pre  : None.
+ * post : Returns an empty arena, or NULL if there is no memory for it.
+ */
+
+void * Arenaalloc (struct arena *, unsigned long);
+/* pre  : We are given a pointer to a valid arena, and a size in bytes.
+ * post : Returns an item of at least that size, aligned to ARENAALIGN,
+ *        or NULL if there is no memory for it.  A small item is cut from
+ *        the current block; an item of ARENALARGE bytes or more is given
+ *        a block of its own.
+ */
+
+void * Arenacalloc (struct arena *, unsigned long, unsigned long);
+/* pre  : We are given a pointer to a valid arena, a number of members,
+ *        and the size in bytes of a member.
+ * post : As Arenaalloc, for an array of the members set to zero.  A large
+ *        array comes from calloc, so that untouched pages cost nothing.
+ */
+
+void * Arenashrink (struct arena *, void *, unsigned long);
+/* pre  : We are given a pointer to a valid arena, an item of the arena,
+ *        and a size in bytes no greater than that of the item.
+ * post : Returns the item cut down to the size, its contents kept.  An
+ *        item with a block of its own is moved by realloc if need be; any
+ *        other item keeps its space, and is returned as it is.
+ */
+
+void * Arenagrow (struct arena *, void *, unsigned long, unsigned long);
+/* pre  : We are given a pointer to a valid arena, an item of the arena,
+ *        the size in bytes it was asked for, and a greater size.
+ * post : Returns the item made up to the greater size, the bytes of the
+ *        first size kept and the rest not set, or NULL, the item left as
+ *        it was, if there is no memory for it.  An item with a block of
+ *        its own is moved by realloc if need be; any other item is copied
+ *        into a new one, its space being released with the arena.
+ */
+
+void Arenafree (struct arena *, void *);
+/* pre  : We are given a pointer to a valid arena, and an item of it.
+ * post : An item with a block of its own is released at once.  Any other
+ *        item is released with the arena.
+ */
+
+unsigned long Arenahighwater (struct arena *);
+/* pre  : We are given a pointer to a valid arena.
+ * post : Returns the most bytes the arena has held at once, its block
+ *        headers and unused ends of blocks included.
+ */
+
+void Deletearena (struct arena **);
+/* pre  : We are given a pointer to an arena pointer, which may be NULL.
+ * post : Every block of the arena is released, one free per block with
+ *        no walk of the items, and the pointer is NULL.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __ARENA_H */
+
+
+/* ********************************** END *********************************** */
@@ -0,0 +1,106 @@
+/*
+********************************************************************************
+* FILE        : convert.h
+* DESCRIPTION : Header file for the conversions between decimals and numbers
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __CONVERT_H
+#define __CONVERT_H
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the chars that Convertfromdouble may write, its NULL included */
+#define CONVERTDOUBLESIZE	32
+
+/* the chars that Convertfromlong may write, its NULL included */
+#define CONVERTLONGSIZE		24
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+double Converttodouble (char *, char **, int *);
+/* pre  : We are given a valid pointer to a token, ended by a NULL or by
+ *        white space, a valid pointer to a character pointer, and a valid
+ *        pointer to an integer.
+ * post : Returns the double closest to the decimal number of the token,
+ *        correctly rounded.  The character pointer is set just past the
+ *        last character of the number, as 'strtod' would set it.
+ *
+ *        The token is read once.  When it has at most 19 significant
+ *        digits, as every MPS value in practice has, the double is made
+ *        by exact arithmetic or by the method of Eisel and Lemire, with a
+ *        table of 128-bit powers of 5; otherwise 'strtod' is used.
+ *
+ *        The integer is set to 1 if the token is not wholly a number,
+ *        in which case 0.0 is returned, else it is set to 0.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int Convertfromdouble (double, char *);
+/* pre  : We are given a double, and a valid pointer to at least
+ *        CONVERTDOUBLESIZE characters.
+ * post : Writes the shortest decimal that Converttodouble, or 'strtod',
+ *        turns back into exactly the double, the one nearest the double
+ *        of those as short, ended by a NULL.  The decimal is written as
+ *        "%g" would write it, in full for a power of 10 from -4 to 15 and
+ *        with an exponent of at least 2 digits otherwise, as in "1e+20";
+ *        infinities and NaN are "inf", "-inf" and "nan".
+ *
+ *        The digits are found by the Schubfach method of Giulietti, with
+ *        a table of 128-bit powers of 10, and no 'sprintf'; without the
+ *        fast conversion of Converttodouble, 'sprintf' is tried at each
+ *        number of digits in turn.
+ *
+ *        Returns the number of characters written, less the NULL.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int Convertfromlong (long, char *);
+/* pre  : We are given a long, and a valid pointer to at least
+ *        CONVERTLONGSIZE characters.
+ * post : Writes the long in decimal, as "%ld" would, ended by a NULL, two
+ *        digits at a time.
+ *
+ *        Returns the number of characters written, less the NULL.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __CONVERT_H */
+
+
+/* ********************************** END *********************************** */
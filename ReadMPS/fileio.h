@@ -27,8 +27,17 @@
 #else
 /* POSIX defines the error return value of "stat" as -1 */
 #define BADSTAT		-1
+
+/* POSIX defines the error return value of "open" as -1 */
+#define BADOPEN		-1
 #endif /* __ANSI__C */
 
+/* 1 megabyte chunk for streaming a file line by line */
+#define LINEBUFFERSIZE	1048576UL
+
+/* 1 megabyte buffer for writing a file in chunks */
+#define WRITEBUFFERSIZE	1048576UL
+
 
 
 /*
@@ -47,6 +56,29 @@ struct datanode {
 #endif /* __ANSI__C */
 
 
+/* a file streamed one chunk at a time, and handed out one line at a time */
+struct linereader {
+   FILE          *infile;    /* the file being streamed                   */
+   char          *buffer;    /* one chunk of the file, plus room for NULL */
+   unsigned long size,       /* the capacity of the chunk                 */
+                 start,      /* the first char not yet handed out         */
+                 end;        /* one past the last char read into buffer   */
+   short         endoffile,  /* set once the file has been read through   */
+                 failed;     /* set if a line would not fit in the chunk  */
+   long          linenumber; /* number of the line last handed out        */
+};
+
+
+/* text and numbers gathered in a buffer, and written to a file in chunks */
+struct filewriter {
+   FILE          *outfile;   /* the file written to, left open           */
+   char          *buffer;    /* the chars not yet written to the file    */
+   unsigned long size,       /* the capacity of the buffer               */
+                 used;       /* the chars held in the buffer             */
+   short         failed;     /* set once a write to the file falls short */
+};
+
+
 
 /*
  *******************************************************************************
@@ -69,6 +101,121 @@ char * Readfileintomemory (char *, unsigned long *);
  *
  *        NULL is returned on any error condition.
  */
+
+char * Mapfileintomemory (char *, unsigned long *);
+/* pre  : We are given a valid character pointer, unsigned long pointer.
+ * post : Returns a pointer to a private, writable mapping of the whole of
+ *        the file identified by the (char *) argument, and the unsigned
+ *        long pointer addresses the file size.  The file is read in on
+ *        demand, and a page is only copied if it is written to, so the
+ *        data is never held twice.
+ *
+ *        Under __ANSI__C, or for an empty file, this is simply
+ *        Readfileintomemory.
+ *
+ *        NULL is returned on any error condition.
+ */
+
+void Releasefilememory (char *, unsigned long);
+/* pre  : We are given a pointer returned by Mapfileintomemory, and the
+ *        file size it gave.
+ * post : The memory holding the file data is given back to the system.
+ */
+
+struct linereader * Openlinereader (char *, unsigned long);
+/* pre  : We are given a valid character pointer, and an unsigned long
+ *        greater than the longest line of the file.
+ * post : Returns a line reader on the file identified by the (char *)
+ *        argument, which will never hold more than the unsigned long
+ *        number of characters of that file at any one time.
+ *
+ *        NULL is returned on any error condition.
+ */
+
+char * Readnextline (struct linereader *);
+/* pre  : We are given a valid pointer to a linereader.
+ * post : Returns the next line of the file as a string without its
+ *        newline, and the line number of the reader is advanced.  A line
+ *        that spans two chunks of the file is joined up first.  The string
+ *        is valid up to the next call, and may be altered by the caller.
+ *
+ *        NULL is returned at the end of the file, or on any error, in
+ *        which case the "failed" flag of the reader is set.
+ */
+
+int Rewindlinereader (struct linereader *);
+/* pre  : We are given a valid pointer to a linereader.
+ * post : The reader is set back to the first line of the file.
+ *
+ *        Returns 1 on success, 0 on failure.
+ */
+
+int Sizelinereader (struct linereader *, unsigned long *);
+/* pre  : We are given a valid pointer to a linereader that has not read
+ *        any line yet, and a pointer to an unsigned long.
+ * post : The unsigned long is set to the size of the file.
+ *
+ *        Returns 1 on success, and 0 if the file cannot be sought, as a
+ *        pipe cannot; nothing is reported.
+ */
+
+void Closelinereader (struct linereader **);
+/* pre  : We are given a pointer to a pointer to a valid linereader.
+ * post : The file is closed, and all memory of the reader is released.
+ */
+
+struct filewriter * Openfilewriter (FILE *, unsigned long);
+/* pre  : We are given a file open for writing, and an unsigned long of at
+ *        least CONVERTDOUBLESIZE.
+ * post : Returns a file writer on the file, which gathers up to the
+ *        unsigned long number of characters before writing them to the
+ *        file in one 'fwrite'.  Numbers are formatted straight into the
+ *        buffer, without 'fprintf', so that a dump of millions of values
+ *        costs little more than the writing of its bytes.  What the
+ *        writer holds reaches the file only as it is flushed, so the file
+ *        is not to be written otherwise in the meantime.
+ *
+ *        NULL is returned on any error condition.
+ */
+
+void Writechars (struct filewriter *, const char *, unsigned long);
+/* pre  : We are given a valid pointer to a filewriter, a pointer to some
+ *        characters, and their number.
+ * post : The characters are added to the writer; as many as fill the
+ *        buffer are written straight to the file.
+ */
+
+void Writestring (struct filewriter *, const char *);
+/* pre  : We are given a valid pointer to a filewriter, and a string.
+ * post : The string, less its NULL, is added to the writer.
+ */
+
+void Writelong (struct filewriter *, long);
+/* pre  : We are given a valid pointer to a filewriter, and a long.
+ * post : The long is added to the writer, as "%ld" would write it.
+ */
+
+void Writedouble (struct filewriter *, double);
+/* pre  : We are given a valid pointer to a filewriter, and a double.
+ * post : The double is added to the writer in the shortest decimal that
+ *        turns back into it, as Convertfromdouble writes it.
+ */
+
+int Flushfilewriter (struct filewriter *);
+/* pre  : We are given a valid pointer to a filewriter.
+ * post : All that the writer holds is written to its file, which is not
+ *        itself flushed, and the buffer is emptied.
+ *
+ *        Returns 1 if every write to the file so far was whole, else 0.
+ */
+
+int Closefilewriter (struct filewriter **);
+/* pre  : We are given a pointer to a pointer to a valid filewriter.
+ * post : The writer is flushed, and all its memory is released; the file
+ *        is left open.
+ *
+ *        Returns 1 if every write to the file was whole, else 0.
+ */
 #ifdef __C__PLUS__PLUS
 }
 #endif /* __C__PLUS__PLUS */
@@ -14,6 +14,17 @@
 
 
 
+/*
+ *******************************************************************************
+ *                               HEADER FILES                                  *
+ *******************************************************************************
+*/
+
+
+#include "arena.h"
+
+
+
 /*
  *******************************************************************************
  *                                  DEFINES                                    *
@@ -22,31 +33,58 @@
 
 
 /*
- * define the size of the array of <row/el/col>structures held in a
- * <row/el/col>node
+ * the load of a hash table, in eighths of its slots, beyond which the
+ * table is doubled in size
  *
- * NOTE : In case of memory problems, reduce this number to 2.
- *        If saturation of the hash tables is expected ( > 8.0e+6 items )
- *        then increase the number to 8 or more
+ * NOTE : open addressing slows sharply as a table fills up, so keep this
+ *        at 7 or less
  *
  */
 
-#define NODE_EL_NUMBER 2
+#define MAXLOADEIGHTHS 7
 
 
 /*
- * define values specific to the hash table initialisations
- *
- * NOTE : it is EXTREMELY INADVISABLE to alter the 4 defines below 
- *		=====================
- *
+ * the number of characters of a name held in a hash table slot itself,
+ * packed into one 64 bit key
+ */
+
+#define SLOTKEYSIZE 8
+
+
+/*
+ * the fewest slots a hash table is given; above this a table is sized
+ * from the expected number of items alone, without an upper bound
+ */
+
+#define MINSLOTS 1024L
+
+
+/*
+ * a minimal perfect hash is made in levels, each of this many bits for
+ * every name still to be placed, and of no more than so many levels
+ */
+
+#define PERFECTGAMMA 2UL
+#define PERFECTMAXLEVELS 48
+
+
+/*
+ * the words of bits of a perfect hash between counts of the bits set,
+ * from which the place of a name is found
  */
 
-#define MINSIZE  500L
-#define MAXSIZE  500000L
+#define PERFECTRANKWORDS 8UL
+
+
+/* the most names a perfect hash takes, keeping a level under 2^32 bits */
 
-#define MINPRIME 1009L
-#define MAXPRIME 1000003L
+#define PERFECTMAXKEYS 0x7FFFFFC0UL
+
+
+/* the most threads a perfect hash is made with */
+
+#define PERFECTMAXTHREADS 16L
 
 
 
@@ -57,71 +95,97 @@
 */
 
 
-/* FOR ROWS */
-
-struct rowstruct {
-   long row_id,     /* unique identifiers for each row, starting at 0 */
-        linenumber; /* the line identifying the location of the row   */
-   char *rowname;   /* pointer to the string naming the row           */
-};
+/*
+ * the row, column and element tables are flat, open addressed tables,
+ * probed in the Robin Hood manner; a slot holds the first SLOTKEYSIZE
+ * characters of its name(s) as 64 bit keys so that most lookups are
+ * integer compares, the names themselves only being read when longer
+ */
 
-struct rowhashnode {
-   int                numelements;              /* number of items in node */
-   struct rowstruct   elements[NODE_EL_NUMBER]; /* array of node data      */
-   struct rowhashnode *nextnode;                /* link to next node       */
+/* a slot of the element table, keyed on the (column, row) names */
+struct hashslot {
+   unsigned long long key1,     /* the column name, packed                */
+                      key2,     /* the row name, packed                   */
+                      hashval;  /* the scrambled hash of the names        */
+   long               id,       /* unused, -1                             */
+                      linenumber; /* the line where the item was declared */
+   const char         *name1,   /* the column name, NULL if empty         */
+                      *name2;   /* the row name                           */
 };
 
 typedef struct {
-   long               arraysize;           /* tally of the number of nodes   */
-   unsigned long      totalcontents;       /* number of items in whole table */
-   struct rowhashnode **rowhashtablearray; /* pointer to node pointers array */
-} rowhashtable;
-
+   long             arraysize;     /* number of slots, a power of 2  */
+   unsigned long    totalcontents; /* number of items in whole table */
+   unsigned long    growths;       /* times the table was doubled    */
+   int              shift;         /* 64 less log2 of arraysize      */
+   struct hashslot  *slots;        /* pointer to the array of slots  */
+   struct arena     *memory;       /* the arena holding the slots    */
+} flathashtable;
 
-/* FOR COLUMNS */
 
-struct colstruct {
-   long col_id,     /* unique identifiers for each column, start at 0  */
-        linenumber; /* the line identifying the location of the column */
-   char *colname;   /* pointer to string naming the column             */
+/*
+ * a slot of the row or column table, keyed on one name; at 40 bytes
+ * against 56 more slots share a cache line while probing
+ */
+struct namehashslot {
+   unsigned long long key1,     /* the name, packed                       */
+                      hashval;  /* the scrambled hash of the name         */
+   long               id,       /* row or column id, starting at 0        */
+                      linenumber; /* the line where the item was declared */
+   const char         *name1;   /* the row/column name, NULL if empty     */
 };
 
-/* developed on the same principle as rowhashnode */
-struct colhashnode {
-   int                numelements;
-   struct colstruct   elements[NODE_EL_NUMBER];
-   struct colhashnode *nextnode;
+typedef struct {
+   long                 arraysize;     /* number of slots, a power of 2  */
+   unsigned long        totalcontents; /* number of items in whole table */
+   unsigned long        growths;       /* times the table was doubled    */
+   int                  shift;         /* 64 less log2 of arraysize      */
+   struct namehashslot  *slots;        /* pointer to the array of slots  */
+   struct arena         *memory;       /* the arena holding the slots    */
+} namehashtable;
+
+
+/* statistics of a hash table, for reporting on how well it was sized */
+struct hashstats {
+   unsigned long items,     /* items held                             */
+                 growths;   /* times the table was doubled            */
+   long          slots,     /* slots of the table                     */
+                 maxprobe;  /* most slots looked at to find an item   */
+   double        load,      /* items per slot                         */
+                 meanprobe; /* mean slots looked at to find an item   */
 };
 
-/* developed on the same principle as rowhashtable */
-typedef struct {
-   long               arraysize;
-   unsigned long      totalcontents;
-   struct colhashnode **colhashtablearray;
-} colhashtable;
 
+/* FOR ROWS, COLUMNS AND ELEMENTS */
 
-/* for elements */
+typedef namehashtable rowhashtable;
+typedef namehashtable colhashtable;
+typedef flathashtable elhashtable;
 
-struct elementstruct {
-   long linenumber;     /* line location of the element */
-   char *columnname,    /* name of the column           */
-        *assoc_rowname; /* name of the row              */
-};
 
-/* developed on the same principle as rowhashnode */
-struct elhashnode {
-   int                  numelements;
-   struct elementstruct elements[NODE_EL_NUMBER];
-   struct elhashnode    *nextnode;
+/*
+ * a minimal perfect hash over a fixed set of names, for lookups once the
+ * tables above are gone: a name goes to the first level where its bit is
+ * that of no other name left, and its place is the number of bits set
+ * before that one.  The id of each name is held at its place, and a name
+ * not in the set is found out by comparing it with the name of that id
+ */
+
+struct perfectshape {
+   unsigned long numkeys,   /* names hashed                            */
+                 numwords,  /* 64 bit words of bits, in all levels     */
+                 numranks;  /* counts of bits set, and one at the end  */
+   long          numlevels; /* levels of bits                          */
+   unsigned long levelstart[PERFECTMAXLEVELS + 1]; /* first bit of each
+                                                       level, and the end */
 };
 
-/* developed on the same principle as rowhashtable */
 typedef struct {
-   long              arraysize;
-   unsigned long     totalcontents;
-   struct elhashnode **elhashtablearray;
-} elhashtable;
+   struct perfectshape shape; /* the sizes, for a snapshot to hold   */
+   unsigned long long  *bits; /* the bits of every level             */
+   unsigned long       *ranks;/* the bits set before each rank block */
+   unsigned int        *ids;  /* the id of the name at each place    */
+} perfecthash;
 
 
 /*
@@ -139,23 +203,45 @@ extern
 unsigned long hashfunction (const unsigned char *,
                              const unsigned char *);
 /* pre  : We are given 2 valid pointers to strings.
- * post : Returns a calculated hash value for the string(s).
+ * post : Returns the 64 bit hash value the hash tables use for the
+ *        string(s), made a word of SLOTKEYSIZE characters at a time;
+ *        a row or column name alone, or the (column, row) names of an
+ *        element together, take a single 128 bit multiply.
  *
  * NOTE : If only one string is to be processed, set the second
- *        argument to "NULL".
+ *        argument to "" or NULL.
  *
  */
 
 
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+unsigned long long hashblock (unsigned long long, 
+                               const unsigned char *, 
+                                unsigned long);
+/* pre  : We are given a 64 bit hash value, a valid pointer to a block of
+ *        memory, and the length of the block in bytes.
+ * post : Returns the hash value carried on over the block, a word of
+ *        SLOTKEYSIZE bytes at a time, to check the contents of a file
+ *        or an image.  A block handed over in pieces, each but the last
+ *        a multiple of SLOTKEYSIZE bytes long, hashes as it would whole.
+ *
+ * NOTE : Start with a hash value of 0.  A short last word is padded with
+ *        zeros, so the length of the block is to be checked apart.
+ */
+
+
 /* specific to row hash tables */
 #ifndef __C__PLUS__PLUS
 extern 
 #endif
-int initrowhashtable (rowhashtable *, long);
-/* pre  : We are given a valid rowhashtable pointer, and a long
- *        integer.
- * post : Creates a row hash table set to best size given from
- *        the long argument.
+int initrowhashtable (rowhashtable *, long, struct arena *);
+/* pre  : We are given a valid rowhashtable pointer, a long
+ *        integer, and a pointer to a valid arena.
+ * post : Creates a row hash table in the arena with room for as many
+ *        rows as the long argument, without an upper bound.  The table
+ *        is doubled later on if it turns out to be too small.
  *
  *        Returns 0 on failure, 1 on success.
  */
@@ -194,9 +280,8 @@ extern
 #endif
 void deleterowhashtable (rowhashtable *);
 /* pre  : We are given a pointer to a valid rowhashtable.
- * post : Safely frees all allocated memory locked
- *        in the row hash table before deleting the table
- *        itself.
+ * post : Releases the array of slots of the row hash table to its
+ *        arena.
  */
 
 
@@ -206,11 +291,12 @@ void deleterowhashtable (rowhashtable *);
 #ifndef __C__PLUS__PLUS
 extern 
 #endif
-int initcolhashtable (colhashtable *, long);
-/* pre  : We are given a valid colhashtable pointer, and a
- *        long integer.
- * post : Creates a column hash table of a size best corresponding
- *        to the value of the given long argument.
+int initcolhashtable (colhashtable *, long, struct arena *);
+/* pre  : We are given a valid colhashtable pointer, a long
+ *        integer, and a pointer to a valid arena.
+ * post : Creates a column hash table in the arena with room for as
+ *        many columns as the long argument, without an upper bound.
+ *        The table is doubled later on if it turns out to be too small.
  *
  *        Returns 1 on success, 0 on failure.
  */
@@ -249,8 +335,8 @@ extern
 #endif
 void deletecolhashtable (colhashtable *);
 /* pre  : We are given a pointer to a valid colhashtable.
- * post : Safely frees all memory locked in the nodes of the
- *        addressed colhashtable before deleting the table itself.
+ * post : Releases the array of slots of the column hash table to its
+ *        arena.
  */
 
 
@@ -260,11 +346,12 @@ void deletecolhashtable (colhashtable *);
 #ifndef __C__PLUS__PLUS
 extern 
 #endif
-int initelhashtable (elhashtable *, long);
-/* pre  : We are given a valid pointer to an elhashtable, and
- *        a long integer.
- * post : Creates an elhashtable of size decided by the value
- *        given by the long argument.
+int initelhashtable (elhashtable *, long, struct arena *);
+/* pre  : We are given a valid pointer to an elhashtable, a long
+ *        integer, and a pointer to a valid arena.
+ * post : Creates an elhashtable in the arena with room for as many
+ *        elements as the long argument, without an upper bound.  The
+ *        table is doubled later on if it turns out to be too small.
  *
  *        Returns 1 on success, 0 on failure.
  */
@@ -291,8 +378,85 @@ extern
 #endif
 void deleteelhashtable (elhashtable *);
 /* pre  : We are given a pointer to a valid elhashtable.
- * post : Safely frees all memory locked in the element hash
- *        table nodes before removing the table itself.
+ * post : Releases the array of slots of the element hash table to its
+ *        arena.
+ */
+
+
+
+/* common to all hash tables */
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+void gethashstats (flathashtable *, struct hashstats *);
+/* pre  : We are given a pointer to a valid element hash table, and a
+ *        valid pointer to a hashstats structure.
+ * post : Fills the structure with the load of the table, the number of
+ *        times it was doubled, and the mean and greatest number of
+ *        slots looked at to find one of its items.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+void getnamehashstats (namehashtable *, struct hashstats *);
+/* pre  : We are given a pointer to a valid row or column hash table,
+ *        and a valid pointer to a hashstats structure.
+ * post : Fills the structure as gethashstats does for an element table.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+void movenamehashtable (namehashtable *, const char *, const char *);
+/* pre  : We are given a pointer to a valid row or column hash table
+ *        whose names are all held in one pool, where that pool was, and
+ *        where it has been moved to.
+ * post : Every name of the table is set to its place in the moved pool.
+ */
+
+
+
+/* specific to perfect hashes */
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int initperfecthash (perfecthash *, 
+                     const char *, 
+                     const unsigned int *, 
+                     long, 
+                     long, 
+                     struct arena *);
+/* pre  : We are given a valid perfecthash pointer, a pool of names and the
+ *        offset of each name in it, the number of names, the number of
+ *        threads to use, and a pointer to a valid arena.  The names are
+ *        all different.
+ * post : Makes a minimal perfect hash of the names in the arena, taking
+ *        about PERFECTGAMMA / (1 - e^(-1 / PERFECTGAMMA)) bits a name for
+ *        its levels and 32 bits for its id.  The hashing and the marking
+ *        of the levels are shared by the threads when the flag
+ *        __SHARED__PARALLEL__PTHREADS is set; otherwise one is used.
+ *
+ *        Returns 0 on failure, 1 on success.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+long findperfect (perfecthash *, 
+                  const char *, 
+                  const unsigned int *, 
+                  const char *);
+/* pre  : We are given a pointer to a perfecthash made by initperfecthash,
+ *        the pool and offsets of its names, which may since have moved,
+ *        and a name.
+ * post : Returns the id of the name, or -1L if it is not one of the names,
+ *        taking one probe of a level for each level passed over.
  */
 
 
@@ -26,6 +26,9 @@
 /* ************************************************************************** */
 
 
+#include <stdio.h>
+#include <limits.h>
+#include <string.h>
 #ifdef __ANSI__C
 #include <float.h>
 #else
@@ -39,7 +42,9 @@
 /* ************************************************************************** */
 
 
+#include "arena.h"
 #include "hash.h"
+#include "scan.h"
 
 
 
@@ -77,7 +82,8 @@
 
 /*
  * maximum values for strings to reduce run-time calculation,
- * including 1 space for their NULL character
+ * including 1 space for their NULL character; the names of rows,
+ * columns and vectors are held to these in fixed format
  */
 
 #define MAX_LPNAMESIZE	   256
@@ -88,6 +94,57 @@
 #define MAX_BNDNAMESIZE	   9
 
 
+/*
+ * in free format a row or column name may be of any length, and an RHS,
+ * RANGES or BOUNDS name, held in the structure itself, of up to this
+ * less 1 for its NULL
+ */
+
+#define MAX_FREENAMESIZE   256
+
+
+/* the formats of an MPS file, as set by SetMPSformat */
+
+#define MPSFORMAT_FIXED	   0
+#define MPSFORMAT_FREE	   1
+
+
+/*
+ * a name in a name pool is preceded by a length byte, which holds this
+ * for a name of this many chars or more, and is followed by its NULL
+ */
+
+#define NAMEPOOLLONG	   255
+#define NAMEPOOLEXTRA	   2UL
+
+
+/* the most chars of a name pool, whose offsets are of 32 bits */
+
+#define MAXNAMEPOOLSIZE	   UINT_MAX
+
+
+/*
+ * the codes of the values of a kernel packed by CompressMPSkernel: the
+ * dictionary holds VALUEDICTSIZE values, the first of them VALUESEAL for
+ * the seal, and an element of VALUERAW has a raw value of its own
+ */
+
+#define VALUEDICTSIZE	255
+#define VALUESEAL	0
+#define VALUERAW	255
+
+
+/*
+ * the histograms of GetMPSstats: the magnitudes of the elements by the
+ * least of MPSDECADES powers of ten from 10^-5 no less than them, and the
+ * rows and columns by their elements up to MPSCOUNTS - 1; the last of
+ * each holds all that are greater
+ */
+
+#define MPSDECADES	11L
+#define MPSCOUNTS	21L
+
+
 /* a series of default values for the rim vectors */
 
 #define DEFAULTRHS	0.0L
@@ -96,6 +153,17 @@
 #define DEFAULTLBD	0.0L
 
 
+/*
+ * the layouts of WriteMPSrims : text of comma separated values, or the rim
+ * vectors as they are held, after MPSRIMSMAGIC and the numbers of rows and
+ * columns as longs
+ */
+
+#define MPSRIMS_CSV	0
+#define MPSRIMS_BINARY	1
+#define MPSRIMSMAGIC	"MPSRIMS1"
+
+
 /*
  * characters to skip from the start sentinel pointer for the "GetX"
  * series of functions
@@ -129,9 +197,21 @@
 #define BADCOL	-1L
 
 
+/*
+ * the row ids of the kernel are held in 32 bits, unless __LARGE__KERNEL
+ * is defined for a model of more rows than that can number
+ */
+
+#ifdef __LARGE__KERNEL
+#define MAXKERNELROWS	LONG_MAX
+#else
+#define MAXKERNELROWS	INT_MAX
+#endif /* __LARGE__KERNEL */
+
+
 /*
  * the maximum number of warnings we state for each of the "GetX"
- * functions that employ "atof"
+ * functions that convert values
  */
 
 #define MAXCOLWARNINGS	2UL
@@ -145,6 +225,25 @@
 #define ASCII_LIMIT	256
 
 
+/* the codes of the MPS sections, in file order, as given to a visitor */
+
+#define STREAM_NONE	0
+#define STREAM_NAME	1
+#define STREAM_ROWS	2
+#define STREAM_COLUMNS	3
+#define STREAM_RHS	4
+#define STREAM_RANGES	5
+#define STREAM_BOUNDS	6
+#define STREAM_ENDATA	7
+
+
+/* the outcomes of VisitMPSdata */
+
+#define VISIT_STOPPED	-1
+#define VISIT_FAILED	0
+#define VISIT_DONE	1
+
+
 
 /*
  *******************************************************************************
@@ -153,10 +252,12 @@
 */
 
 
-struct rowdata {
-   long	  rowid; /* the unique id for row                 */
-   double value; /* the value associated with the element */
-};
+/* the row id of an element of the kernel */
+#ifdef __LARGE__KERNEL
+typedef long kernelindex;
+#else
+typedef int kernelindex;
+#endif /* __LARGE__KERNEL */
 
 
 struct MPSstruct {
@@ -168,13 +269,23 @@ struct MPSstruct {
    unsigned long  numberelements,         /* total elements > 0.0L      */
 		  numberzeroelements;     /* total elements = 0.0L      */
 
-   char		  **rownames, /* points to array of row names    */
-		  **colnames, /* points to array of column names */
+   /*
+    * the row (column) names lie one after another in a pool, each as its
+    * length byte, its chars and a NULL, and are found by the 32 bit offset
+    * of their chars through MPSROWNAME (MPSCOLNAME); until the load sets
+    * them, rownamesize and colnamesize hold the room of the pools
+    */
+   char		  *rownamepool,    /* the row names, one after another    */
+		  *colnamepool;    /* the column names, one after another */
+   unsigned int	  *rownameoffsets, /* the offset of each row name         */
+		  *colnameoffsets; /* the offset of each column name      */
+   unsigned long  rownamesize,     /* the chars of the row name pool      */
+		  colnamesize;     /* the chars of the column name pool   */
 
                   /* preserved rhs, ranges, bounds names */
-                  rhsname[MAX_RHSNAMESIZE], /* for RHS    */
-                  ranname[MAX_RANNAMESIZE], /* for RANGES */
-                  bndname[MAX_BNDNAMESIZE], /* for BOUNDS */
+   char		  rhsname[MAX_FREENAMESIZE], /* for RHS    */
+                  ranname[MAX_FREENAMESIZE], /* for RANGES */
+                  bndname[MAX_FREENAMESIZE], /* for BOUNDS */
 
                   /* the rim vectors */
 		  *relationalcodesvector; /* char array   */
@@ -184,13 +295,198 @@ struct MPSstruct {
 	          *upperboundsvector,	   /*      "       */
 		  *lowerboundsvector;	   /*      "       */
 
-   /* the kernel */
-   struct rowdata *kerneldata_row,  /* the actual kernel data             */
-		  **kerneldata_col; /* columnwise pointers to kernel data */
+   /* 
+    * the kernel, column by column; the elements of column j are those
+    * from kernel_colstart[j] up to kernel_colstart[j+1], in row order
+    */
+   kernelindex	  *kernel_rowid;    /* the row id of each element      */
+   double	  *kernel_value;    /* the value of each element       */
+   unsigned long  *kernel_colstart; /* the first element of each column */
+
+   /*
+    * the values of the kernel once CompressMPSkernel has packed them, and
+    * NULL until then, when kernel_value is NULL instead: element k has
+    * code kernel_code[k], the place of its value in kernel_dict, or else
+    * VALUERAW for the next raw value, these lying in element order, and
+    * those of column j from kernel_rawstart[j]
+    */
+   unsigned char  *kernel_code;     /* the code of each element         */
+   double	  *kernel_dict;     /* the VALUEDICTSIZE common values  */
+   double	  *kernel_raw;      /* the values of code VALUERAW      */
+   unsigned long  *kernel_rawstart; /* the first raw value of each column */
+   double	  *kernel_column;   /* a column decoded by GetMPScolumn */
+
+   /*
+    * the kernel row by row, made by BuildMPSrowview on first use and NULL
+    * until then; the elements of row i are those from rowview_rowstart[i]
+    * up to rowview_rowstart[i+1], in column order
+    */
+   kernelindex	  *rowview_colid;    /* the column id of each element  */
+   double	  *rowview_value;    /* the value of each element      */
+   unsigned long  *rowview_rowstart; /* the first element of each row  */
+
+   /* the statistics of the kernel, made by GetMPSstats on first use */
+   struct mpsstats *stats;
+
+   /*
+    * minimal perfect hashes of the final row and column names, made at
+    * the end of a load once the hash tables of the load are gone, and
+    * looked up by FindMPSrow and FindMPScol
+    */
+   perfecthash	  rowlookup,
+		  collookup;
+
+   /* a snapshot image the arrays above point into, else NULL */
+   char		  *image;
+   unsigned long  imagesize;
+
+   /* the region holding the structure and all of the above */
+   struct arena	  *memory;
+};
+
+
+/*
+ * the callbacks of VisitMPSdata, any of which may be NULL; each is given
+ * the user data, and returns 1 to go on or 0 to stop the visit.  A name
+ * is a view into the line buffer, and is only valid during the call
+ */
+struct mpsvisitor {
+   int (*name)       (void *, const char *);          /* lp name        */
+   int (*row)        (void *, long, char, const char *); /* id, type, name */
+   int (*column)     (void *, long, const char *);    /* id, name       */
+   int (*element)    (void *, long, long, double);    /* col, row, value */
+   int (*rim)        (void *, int, const char *, long, double);
+					/* section, vector, row id, value */
+   int (*bound)      (void *, const char *, const char *, long, double);
+					/* type, vector, col id, value    */
+   int (*endsection) (void *, int);                   /* STREAM_ code   */
+};
+
+
+/*
+ * what the last load of GetMPSdata took, as GetMPSprofile gives it; the
+ * times are of the monotonic clock, in seconds.  The split of COLUMNS is
+ * only made under __PROFILE__MPS, as it reads the clock on every line,
+ * and its times are otherwise 0.0; COLUMNS read by threads under
+ * __SHARED__PARALLEL__PTHREADS is neither split nor its purges counted.
+ * The flags tell which of them were measured
+ */
+struct mpsprofile {
+   double	  readtime,     /* the file mapped and its lines indexed */
+		  scantime,     /* the sections found and counted        */
+		  inittime,     /* the MPSstruct made                    */
+		  nametime,     /* NAME                                  */
+		  rowstime,     /* ROWS, its hash table made             */
+		  columnstime,  /* COLUMNS, its hash table made          */
+		  tokentime,    /*   the fields of its lines found       */
+		  hashtime,     /*   its row and column names looked up  */
+		  purgetime,    /*   the elements of its columns ordered */
+		  filltime,     /*   its values read, kernel and names   */
+		  lookuptime,   /* the name lookups of the model made    */
+		  rhstime,      /* RHS                                   */
+		  rangestime,   /* RANGES                                */
+		  boundstime,   /* BOUNDS                                */
+		  totaltime,    /* the whole load                        */
+		  bytespersec;  /* the file size over the whole load     */
+
+   unsigned long  filesize,     /* the chars of the file                 */
+		  purgesingle,  /* columns of one element, put in place  */
+		  purgepair,    /* columns of two, put in order at once  */
+		  purgeordered, /* columns found in order by a sweep     */
+		  purgeinsert,  /* columns sorted by insertion           */
+		  purgeradix,   /* columns sorted by radix               */
+		  arenablocks,  /* the blocks of the arena at the end    */
+		  arenahigh;    /* the most bytes the arena held at once */
+
+   double	  rowprobes,    /* the mean slots looked at, per row     */
+		  colprobes;    /*   and column name of the hash tables  */
+   long		  rowmaxprobe,  /* the most slots looked at, per row     */
+		  colmaxprobe,  /*   and column name                     */
+		  peakrss;      /* the peak kilobytes of the process     */
+
+   int		  splittimed,   /* 1 if the split of COLUMNS was timed   */
+		  purgescounted;/* 1 if the purges of COLUMNS counted    */
+};
+
+
+/*
+ * the statistics of the kernel of an MPSstruct, as GetMPSstats makes them
+ * in one pass; the magnitudes are those of the elements held, which are
+ * never zero, and those given as zero are counted apart
+ */
+struct mpsstats {
+   unsigned long  decades[MPSDECADES],  /* elements by magnitude          */
+		  rowcounts[MPSCOUNTS], /* rows by their elements         */
+		  colcounts[MPSCOUNTS], /* columns by their elements      */
+		  *rowelements,         /* the elements of each row       */
+		  zeroelements;         /* elements given as zero         */
+
+   long		  emptyrows,   /* rows of no elements                     */
+		  emptycols,   /* columns of no elements                  */
+		  longestrow,  /* the most elements of a row              */
+		  longestcol;  /* the most elements of a column           */
+
+   double	  minabs,      /* the least magnitude, 0.0 if no elements */
+		  maxabs,      /* the greatest magnitude, and max norm    */
+		  norm1,       /* the sum of the magnitudes               */
+		  norm2;       /* the Frobenius norm                      */
+};
+
+
+/*
+ * the sections of an MPS file up to "RHS", and the counts of the "ROWS"
+ * and "COLUMNS" data lines, as Scansections finds them while the line
+ * index is built; a line is of no section unless its first character
+ * says so, as for SetSectionPtrs
+ */
+struct sectionscan {
+   int           section;  /* the STREAM_ section of the last line     */
+   unsigned long nameline, /* the first line to start with 'N'         */
+                 rowline,  /* the next to start with 'R'               */
+                 colline,  /* the next to start with 'C'               */
+                 rhsline;  /* the next to start with 'R'               */
+   long          rowctr,   /* the lines after ROWS, that with 'C' too  */
+                 colctr,   /* the lines after COLUMNS, with 'R' too    */
+                 numcols;  /* the columns of the COLUMNS lines         */
+   unsigned long numels,   /* the elements they give                   */
+                 rowchars, /* the chars of the row names               */
+                 colchars; /* the chars of the column names            */
+   char          lastcol[MAX_FREENAMESIZE]; /* the column of the line  */
+                                             /* before                  */
 };
 
 
 
+/*
+ *******************************************************************************
+ *			              MACROS                                   *
+ *******************************************************************************
+*/
+
+
+#define MPSROWNAME(mps,i)	((mps)->rownamepool + \
+				  *((mps)->rownameoffsets + (i)))
+/* pre  : We are given a pointer to a valid MPSstruct, and a row id.
+ * post : Returns the name of the row, as a string in its name pool.
+ */
+
+#define MPSCOLNAME(mps,i)	((mps)->colnamepool + \
+				  *((mps)->colnameoffsets + (i)))
+/* pre  : We are given a pointer to a valid MPSstruct, and a column id.
+ * post : Returns the name of the column, as a string in its name pool.
+ */
+
+#define MPSNAMELENGTH(name)	\
+	 ((*((const unsigned char *) (name) - 1) < NAMEPOOLLONG) ? \
+	  (unsigned long) *((const unsigned char *) (name) - 1) : \
+	   (unsigned long) strlen (name))
+/* pre  : We are given a name returned by MPSROWNAME or MPSCOLNAME.
+ * post : Returns the length of the name from its length byte, and only
+ *	  counts the chars of a name of NAMEPOOLLONG chars or more.
+ */
+
+
+
 /*
  *******************************************************************************
  *	                           PROTOTYPES                                  *
@@ -203,12 +499,29 @@ extern "C" {
 #else
 extern 
 #endif /* __C__PLUS__PLUS */
-struct MPSstruct *InitMPSstruct (long, long);
-/* pre  : We are given two valid long integers.
+struct MPSstruct *InitMPSstruct (long, 
+                                  long, 
+                                   unsigned long, 
+                                    unsigned long, 
+                                     unsigned long);
+/* pre  : We are given the number of rows, the number
+ *	  of columns and of elements the load may set, and
+ *	  the chars the row and the column names may take
+ *	  in their pools, as counted by SetSectionPtrs.
  * post : Returns a pointer to a generated MPSstruct
  *	  whose row number corresponds to the first
- *	  argument, and whose column number initially
- *	  matches the second argument.
+ *	  argument, and whose column, kernel and name arrays
+ *	  are made once at the sizes given; until the load
+ *	  sets them, its numbercols, numberelements,
+ *	  rownamesize and colnamesize hold those sizes.
+ *
+ *	  The structure and all of its arrays are taken from one
+ *	  arena, held in the structure, so that any failure, here
+ *	  or later in the load, needs only the arena released.
+ *
+ *	  NULL is returned should the rows be more than a row id
+ *	  of the kernel can hold, MAXKERNELROWS, or a name pool
+ *	  be of more than MAXNAMEPOOLSIZE chars.
  */
 
 
@@ -216,9 +529,12 @@ struct MPSstruct *InitMPSstruct (long, long);
 extern 
 #endif
 void DeleteMPSstruct (struct MPSstruct **);
-/* pre  : We are given a pointer to a pointer to a valid MPSstruct.
- * post : Safely removes all "malloc"-ed items in the MPSstruct prior
- *	  to deleting the structure itself.
+/* pre  : We are given a pointer to a pointer to a valid MPSstruct, or
+ *	  to NULL.
+ * post : Releases the arena of the MPSstruct, and so the structure,
+ *	  its arrays, and any scratch memory of a load taken from it,
+ *	  in one call, as well as any snapshot image it was loaded
+ *	  from.  The pointer is NULL.
  */
 
 
@@ -235,10 +551,17 @@ int SetSectionPtrs (char *,
                            char **, 
                             long *, 
                              long *,
-			      unsigned long);
+                              unsigned long *,
+                               unsigned long *,
+                                unsigned long *,
+			         unsigned long,
+			          struct lineindex *,
+			           struct sectionscan *);
 /* pre  : We are given a pointer to an array of characters, 7 character
- *	  pointer pointers, 2 long integer pointers, and an unsigned long
- *	  value.
+ *	  pointer pointers, 2 long integer pointers, 3 unsigned long
+ *	  pointers, an unsigned long value, a pointer to the line index
+ *	  of the array, and the sections Scansections found as the index
+ *	  was built.
  * post : Assigns the character pointer pointers to each possible section
  *	  that can be found in an MPS file.  Since "RANGES" and "BOUNDS" are
  *	  optional MPS sections, their corresponding pointer pointers to char
@@ -253,23 +576,50 @@ int SetSectionPtrs (char *,
  *	  file has an empty "RHS" section we issue a warning but continue
  *	  processing.
  *
+ *	  The sections up to "RHS", and the counts of rows, columns,
+ *	  elements and chars of names, are taken from the scan rather than
+ *	  from another pass over the lines; they are exact for a valid file.
+ *
  *	  Returns 1 on success, and 0 on failure.
  */
 
 
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+void Scansections (void *, 
+                    const char *, 
+                     const unsigned long *, 
+                      unsigned long, 
+                       unsigned long);
+/* pre  : A linevisitor, given a pointer to a sectionscan as its argument,
+ *	  for Buildlineindex to call with the lines of the file in order.
+ * post : The scan is set up on the first line.  The sections are then
+ *	  found from the first character of each line, and the lines of the
+ *	  "ROWS" and "COLUMNS" sections are counted by countrowline and
+ *	  countcolline as they go by, while they are still in cache; the
+ *	  lines after the one heading "RHS" are passed over.
+ */
+
+
 #ifndef __C__PLUS__PLUS
 extern 
 #endif
-int GetNAME	(char **, struct MPSstruct **, char *, long *);
+int GetNAME	(char **, 
+                 struct MPSstruct **, 
+                  char *, 
+                   long *, 
+                    struct lineindex *);
 /* pre  : We are given a valid pointer pointer to an array of char, a
- *	  pointer pointer to a valid MPSstruct, character pointer, and a 
- *	  long integer pointer.
+ *	  pointer pointer to a valid MPSstruct, character pointer, a 
+ *	  long integer pointer, and a pointer to the line index of the
+ *	  array.
  * post : Isolates the "NAME" section from the array, making sure it does
  *	  not overflow the sentinel value set in the char * argument.
  *	  Updates the MPSstruct's name field to hold the MPS file's name if
- *	  it is given, else that name field holds NULL.  The number of lines
- *	  that the code had to traverse is recorded to help with the final
- *	  update of the long integer addressed by the long * argument.
+ *	  it is given, else that name field holds NULL.  The long integer
+ *	  addressed by the long * argument is set to the number of the line
+ *	  holding the sentinel, as found from the index.
  *
  *	  The array of characters is updated to create strings, through adding
  *	  NULL delimiters.
@@ -301,8 +651,10 @@ int GetROWS	(char **,
  *	  value held by the fourth argument.  The long integer is updated at
  *	  the end to reflect the number of lines read.
  *
- *	  The function checks that a row is not defined twice, and that the
- *	  type of a row is only 'N', 'L', 'G', or 'E'.
+ *	  The function checks that a row is not defined twice, that the
+ *	  type of a row is only 'N', 'L', 'G', or 'E', and that its name is
+ *	  no longer than the format set by SetMPSformat allows.  The names
+ *	  are copied into the row name pool.
  *
  *	  Returns 1 on success, 0 on failure.
  */
@@ -313,21 +665,21 @@ extern
 #endif
 int GetCOLUMNS	(char **, 
                   struct MPSstruct **, 
-                   elhashtable *,
-		    colhashtable *, 
-                     rowhashtable *, 
-                      char *, 
+		   colhashtable *, 
+                    rowhashtable *, 
+                     char *, 
+                      struct lineindex *,
                        long *);
 /* pre  : We are given a pointer to a pointer to an array of characters, a
  *	  pointer to a pointer to a valid MPSstruct, a pointer to a valid
- *	  element hash table, a pointer to a valid column hash table, a
- *	  pointer to a valid row hash table, a character pointer, and a
+ *	  column hash table, a pointer to a valid row hash table, a character
+ *	  pointer, a pointer to the valid line index of the file, and a
  *	  pointer to a long integer.
  * post : The scanned array of characters stretches from the first argument
- *	  to the sentinel limit held in the sixth argument; this is the
- *	  "COLUMNS" section of the MPS input file.  The element hash table and
- *	  the column hash table are updated with element and column data,
- *	  helped by referencing row data held in the unchanging rowhashtable.
+ *	  to the sentinel limit held in the fifth argument; this is the
+ *	  "COLUMNS" section of the MPS input file.  The column hash table is
+ *	  updated with column data, helped by referencing row data held in
+ *	  the unchanging rowhashtable.
  *	  The MPSstruct is updated with the column names and the kernel data
  *	  and then a truncation operation is performed to shrink the column-
  *	  related arrays since the number of columns and elements is
@@ -337,23 +689,65 @@ int GetCOLUMNS	(char **,
  *	  The function checks for the following: duplicate column names,
  *	  duplicate elements in the same section, elements defined in
  *	  non-contiguous column sections, elements defined with an incorrect
- *	  rowname or a name that does not exist.
+ *	  rowname or a name that does not exist, and column names longer
+ *	  than the format set by SetMPSformat allows.
+ *
+ *	  No element hash table is kept.  A duplicate element in a block of
+ *	  lines of a column is caught by the stamp of its row, the column id
+ *	  + 1 of its last setting.  When a column is given again in a later
+ *	  block, each nonzero element of the block is first sought by binary
+ *	  search in the kernel of the earlier block, so that a repeated
+ *	  element is reported, with the line of the earlier one found through
+ *	  the line index, before the column is refused.
  *	  
- *	  If the 'atof' function should give a value of a double as '0.0',
- *	  then, up to a limit, a warning is issued, but processing continues.
+ *	  If a value should convert to a double of '0.0', then, up to a
+ *	  limit, a warning is issued, but processing continues.  A value
+ *	  that is not a number is an error, given with its line number.
  *
  *	  This is the only location for the sort function, used to sort the
  *	  element data of a column rowwise before entry into the kernel.  The
  *	  kernel is sealed by a special element item of row id -1 and value
- *	  0.0 and the last colptr item points to this seal.  Columns can be
- *	  addressed via their location in the "colptrs" array of the 
+ *	  0.0 and the last column start is that of this seal.  Columns can be
+ *	  addressed via their location in the "kernel_colstart" array of the 
  *	  MPSstruct.
  *
  *	  The array of characters is updated to create strings, through adding
  *	  NULL delimiters.
  *
+ *	  The scratch arrays are taken from the arena of the MPSstruct.  On
+ *	  failure they are left for DeleteMPSstruct to release with it.
+ *
+ *	  Returns 1 on success, 0 on failure.
+ */
+
+
+#ifdef __SHARED__PARALLEL__PTHREADS
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int GetCOLUMNSparallel	(char **, 
+                          struct MPSstruct **, 
+		           colhashtable *, 
+                            rowhashtable *, 
+                             char *, 
+                              struct lineindex *,
+                               long *);
+/* pre  : As GetCOLUMNS.
+ * post : As GetCOLUMNS, but the "COLUMNS" section is cut into chunks at
+ *	  lines where the column name changes, and each chunk is parsed
+ *	  into its own kernel buffer by a thread of its own.  The columns
+ *	  are then added to the column hash table in file order, and the
+ *	  buffers are copied into the kernel at offsets given by a prefix
+ *	  sum, so that the MPSstruct and every message are as GetCOLUMNS
+ *	  gives.
+ *
+ *	  The number of threads is that of the online processors, up to
+ *	  MAXTHREADS, unless the environment variable READMPS_THREADS
+ *	  sets it.  A single thread falls back on GetCOLUMNS.
+ *
  *	  Returns 1 on success, 0 on failure.
  */
+#endif /* __SHARED__PARALLEL__PTHREADS */
 
 
 #ifndef __C__PLUS__PLUS
@@ -375,8 +769,9 @@ int GetRHS	(char **,
  *	  The RHS name is saved, and the dense RHS vector field of the MPS
  *	  structure is updated to reflect the values provided.
  *
- *	  If the 'atof' function should give a value of a double as '0.0',
- *	  then, up to a limit, a warning is issued, but processing continues.
+ *	  If a value should convert to a double of '0.0', then, up to a
+ *	  limit, a warning is issued, but processing continues.  A value
+ *	  that is not a number is an error, given with its line number.
  *
  *	  The array of characters is updated to create strings, through adding
  *	  NULL delimiters.
@@ -408,8 +803,9 @@ int GetRANGES	(char **,
  *	  The RANGES name is saved, and the dense RANGES vector field of the
  *	  MPS structure is updated to reflect the values provided.
  *
- *	  If the 'atof' function should give a value of a double as '0.0',
- *	  then, up to a limit, a warning is issued, but processing continues.
+ *	  If a value should convert to a double of '0.0', then, up to a
+ *	  limit, a warning is issued, but processing continues.  A value
+ *	  that is not a number is an error, given with its line number.
  *
  *	  The array of characters is updated to create strings, through adding
  *	  NULL delimiters.
@@ -428,11 +824,12 @@ int GetBOUNDS 	(char **,
                  struct MPSstruct **, 
                   colhashtable *,
 		   char *, 
-                    long *);
+                    long *,
+                     struct lineindex *);
 /* pre  : We are given a pointer to a pointer to an array of characters,
  *	  a pointer to a pointer to a valid MPSstruct, a pointer to a valid
- *	  column hash table, a character pointer, and a pointer to a long
- *	  integer.
+ *	  column hash table, a character pointer, a pointer to a long
+ *	  integer, and a pointer to the line index of the array.
  * post : The scanned array of characters stretches from the first argument
  *	  to the sentinel limit held in the fourth argument; this is the 
  *	  "BOUNDS" section of the MPS input file.  The column hash table is not
@@ -444,8 +841,9 @@ int GetBOUNDS 	(char **,
  *	  to reflect the values provided.  The exact values are preset to
  *	  +(infinity) and zero respectively first of all.
  *
- *	  If the 'atof' function should give a value of a double as '0.0',
- *	  then, up to a limit, a warning is issued, but processing continues.
+ *	  If a value should convert to a double of '0.0', then, up to a
+ *	  limit, a warning is issued, but processing continues.  A value
+ *	  that is not a number is an error, given with its line number.
  *
  *	  The array of characters is updated to create strings, through adding
  *	  NULL delimiters.
@@ -457,6 +855,34 @@ int GetBOUNDS 	(char **,
  */
 
 
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int SetMPSformat (int);
+/* pre  : We are given MPSFORMAT_FIXED or MPSFORMAT_FREE.
+ * post : The files read from now on are taken to be of that format, and
+ *	  the format set until now is returned; MPSFORMAT_FIXED is set to
+ *	  begin with.
+ *
+ *	  Both formats take the fields of a line to be those its white
+ *	  space separates.  In fixed format a name is of no more than the
+ *	  8 chars of its fixed field, and in free format a row or column
+ *	  name is of any length, and an RHS, RANGES or BOUNDS name of less
+ *	  than MAX_FREENAMESIZE chars; a name too long is an error.  Either
+ *	  way the names are held in the name pools of the MPSstruct.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int GetMPSformat (void);
+/* pre  : None.
+ * post : Returns the format the files are read in, as SetMPSformat last
+ *	  set it.
+ */
+
+
 #ifndef __C__PLUS__PLUS
 extern 
 #endif
@@ -470,6 +896,244 @@ struct MPSstruct *GetMPSdata (char *);
  *	  data residing within it.
  */
 
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+void GetMPSprofile (struct mpsprofile *);
+/* pre  : We are given a valid pointer to a mpsprofile.
+ * post : The mpsprofile is set to what the last call of GetMPSdata took,
+ *	  phase by phase, and all 0 if there has been none; the phases of
+ *	  a load that failed are given up to the one that failed.  A load
+ *	  of another kind leaves the profile as it is.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+struct MPSstruct *GetMPSdatastream (char *);
+/* pre  : We are given a valid pointer to a string of characters.
+ * post : As GetMPSdata, but the MPS input file is streamed through a
+ *	  buffer of LINEBUFFERSIZE characters rather than held in memory,
+ *	  so that the peak memory is bounded by the size of the model.
+ *
+ *	  A file that can be sought is read twice, once to size the
+ *	  structure exactly and once to fill it.  A pipe, such as
+ *	  "zcat model.mps.gz | readmps /dev/stdin", is read once, the
+ *	  arrays being doubled as they fill and shrunk to size at the end.
+ *
+ *	  The messages are those of GetMPSdata but for these:
+ *	  - a column given in two blocks of lines is refused at the first
+ *	    line of the second block, even if that block repeats an element
+ *	    of the first, which GetMPSdata reports as a duplicate element;
+ *	  - the lines given for such a column are those that begin the two
+ *	    blocks, where GetMPSdata gives those that follow them;
+ *	  - zero values are warned of as they are read, not as their column
+ *	    ends, so that the warnings may come in another order;
+ *	  - a pipe has its sections checked as they come, so that an error
+ *	    of a line is reported before one of a later section, and one
+ *	    too small to be MPS is refused by the section it lacks.
+ *
+ *	  In any error situation, it returns NULL, otherwise it returns a
+ *	  pointer to an internally allocated MPS structure with the MPS
+ *	  data residing within it.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int BuildMPSrowview (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : The row view of the kernel is made in the arena of the structure,
+ *	  unless it is there already, by a pass counting the elements of each
+ *	  row and a pass scattering them into place; the kernel is not
+ *	  altered.  Under __SHARED__PARALLEL__PTHREADS each pass is shared
+ *	  by threads over bands of columns of about as many elements, each
+ *	  counting its rows apart, as many as for GetCOLUMNSparallel.
+ *
+ *	  The view is kept until ReleaseMPSrowview or DeleteMPSstruct, and
+ *	  a snapshot does not hold it.  Two threads may not make the view of
+ *	  one structure at once, but once it is made any may read it.
+ *
+ *	  Returns 1 on success, 0 on failure.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+long GetMPSrow (struct MPSstruct *, long, kernelindex **, double **);
+/* pre  : We are given a pointer to a valid MPSstruct, a row id, and two
+ *	  valid pointers to be set.
+ * post : The pointers are set to the column ids, in order, and the values
+ *	  of the elements of the row, the row view being made on first use.
+ *
+ *	  Returns the number of elements of the row, or -1L if the row id is
+ *	  not valid or the view cannot be made.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+void ReleaseMPSrowview (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : The memory of any row view of the structure is given back to its
+ *	  arena, and the view is made again on its next use.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int CompressMPSkernel (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : The values of the kernel are packed, unless they are already or
+ *	  would take no less room so: the VALUEDICTSIZE - 1 values most
+ *	  common among the first of the kernel make a dictionary, each
+ *	  element is given a byte, the code of its value in it or VALUERAW,
+ *	  and the rest of the values are kept raw.  kernel_value is then
+ *	  released and NULL, and the values are to be had by GetMPScolumn
+ *	  or GetMPSrow.  The values of a structure on a snapshot image are
+ *	  packed from the image into the arena, the image keeping its pages
+ *	  until the structure is deleted.
+ *
+ *	  The packing is exact, and cannot be undone but by reading the
+ *	  model again; a snapshot of the structure holds the values whole.
+ *
+ *	  Returns 1 on success, 0 on failure, which leaves the kernel as it
+ *	  was.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+long GetMPScolumn (struct MPSstruct *, long, kernelindex **, double **);
+/* pre  : We are given a pointer to a valid MPSstruct, a column id, and two
+ *	  valid pointers to be set.
+ * post : The pointers are set to the row ids, in order, and the values of
+ *	  the elements of the column.  The values of a packed kernel are
+ *	  decoded into a column buffer of the structure, which the next call
+ *	  overwrites, so that two threads may not call this at once on one
+ *	  packed structure.
+ *
+ *	  Returns the number of elements of the column, or -1L if the column
+ *	  id is not valid.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+double MPSkernelratio (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : Returns the bytes the values of the kernel take as doubles over
+ *	  those they take as packed by CompressMPSkernel, 1.0 if they are not
+ *	  packed.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+struct mpsstats * GetMPSstats (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : The statistics of the kernel are made in the arena of the
+ *	  structure, unless they are there already, by one pass over the
+ *	  kernel; under __SHARED__PARALLEL__PTHREADS the pass is shared by
+ *	  threads, each over a band of columns, as many as for
+ *	  BuildMPSrowview, and the row counts of the threads are summed
+ *	  after.  The norms are summed over fixed blocks of columns, so that
+ *	  they do not change with the number of threads.  Each magnitude is
+ *	  put in its decade from the exponent of the value, without a search
+ *	  of the decades.
+ *
+ *	  The statistics are kept until DeleteMPSstruct, and a snapshot does
+ *	  not hold them.  Two threads may not make the statistics of one
+ *	  structure at once, but once they are made any may read them.
+ *
+ *	  Returns the statistics, or NULL if there is no memory for them.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int WriteMPSrims (struct MPSstruct *, FILE *, int);
+/* pre  : We are given a pointer to a valid MPSstruct, a file open for
+ *	  writing, and MPSRIMS_CSV or MPSRIMS_BINARY.
+ * post : The rim vectors are written to the file through a buffer of
+ *	  WRITEBUFFERSIZE characters, in as few writes as it takes, and the
+ *	  file is flushed once at the end.
+ *
+ *	  As MPSRIMS_CSV, a header line is followed by a line for each row,
+ *	  "row,name,type,rhs,range,,", and then one for each column,
+ *	  "column,name,,,,lower,upper", in the order of their ids.  Each
+ *	  value is the shortest decimal that turns back into it, and an
+ *	  infinite bound is "inf" or "-inf".  A name holding a comma, a
+ *	  quote or a space is quoted.
+ *
+ *	  As MPSRIMS_BINARY, MPSRIMSMAGIC and the numbers of rows and of
+ *	  columns, as longs, are followed by the RHS, RANGES, LOWER BOUNDS
+ *	  and UPPER BOUNDS vectors, as doubles, and the relational codes of
+ *	  the rows, all in the byte order of the machine.
+ *
+ *	  Returns 1 on success, 0 on failure.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+long FindMPSrow (struct MPSstruct *, char *);
+/* pre  : We are given a pointer to an MPSstruct made by GetMPSdata,
+ *	  GetMPSdatastream or from a snapshot, and a name.
+ * post : Returns the id of the row of the name, or -1L if there is no
+ *	  such row, in one probe of its name lookup for most names.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+long FindMPScol (struct MPSstruct *, char *);
+/* pre  : We are given a pointer to an MPSstruct made by GetMPSdata,
+ *	  GetMPSdatastream or from a snapshot, and a name.
+ * post : Returns the id of the column of the name, or -1L if there is no
+ *	  such column, in one probe of its name lookup for most names.
+ */
+
+
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int VisitMPSdata (char *, struct mpsvisitor *, void *);
+/* pre  : We are given a valid pointer to a string of characters, a valid
+ *	  pointer to a mpsvisitor, and the user data for its callbacks.
+ * post : The MPS input file is streamed once through a buffer of
+ *	  LINEBUFFERSIZE characters, and each line is handed to the callback
+ *	  of the visitor for it, in the order of the file, without any
+ *	  MPSstruct being built.  Rows and columns are numbered from 0 as
+ *	  GetMPSdata numbers them; a column is given before its elements,
+ *	  and each section is ended before the next begins.
+ *
+ *	  The checks and messages are those of GetMPSdatastream, and
+ *	  zero-valued elements, RHS and RANGES values are warned of and not
+ *	  given.  A bound is given as read, with 0.0 for a missing value,
+ *	  for the callback to apply as GetBOUNDS does; one of an undefined
+ *	  type is warned of and not given.  Only the row and column names
+ *	  are kept, so that the memory taken is that of the names and not
+ *	  of the elements or the file.
+ *
+ *	  As the file is checked as it is read, callbacks may have been
+ *	  made before an error is found.  Returns VISIT_DONE if the whole
+ *	  file is visited, VISIT_STOPPED if a callback returns 0, and
+ *	  VISIT_FAILED on error.
+ */
+
 #ifdef __C__PLUS__PLUS
 }
 #endif /* __C__PLUS__PLUS */
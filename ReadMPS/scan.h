@@ -0,0 +1,122 @@
+/*
+********************************************************************************
+* FILE        : scan.h
+* DESCRIPTION : Header file for the vectorised newline scanning routines
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __SCAN_H
+#define __SCAN_H
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the characters scanned at a time when the line index is being built */
+#define SCANBLOCKSIZE	65536UL
+
+
+
+/*
+ *******************************************************************************
+ *                      	STRUCTURES				       *
+ *******************************************************************************
+*/
+
+
+/*
+ * A line visitor is given its argument, the array being indexed, the line
+ * starts found so far, and the first and one past the last of the lines
+ * whose ends are now known; line i runs from starts[i] up to starts[i+1].
+ */
+typedef void (*linevisitor) (void *,
+                              const char *,
+                               const unsigned long *,
+                                unsigned long,
+                                 unsigned long);
+
+
+/* the offsets of the start of every line of an array of characters */
+struct lineindex {
+   const char    *data;      /* the array of characters indexed            */
+   unsigned long numlines,   /* lines starting before the end of the array */
+                 arraysize,  /* the lines the starts array can hold        */
+                 *starts;    /* line start offsets, then the array size    */
+};
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+struct lineindex * Buildlineindex (const char *, unsigned long,
+                                    linevisitor, void *);
+/* pre  : We are given a valid pointer to an array of characters, its
+ *        size, and a line visitor and its argument, or NULL and NULL.
+ * post : Returns an index holding the offset of the start of every line
+ *        of the array, built in one pass, 'starts[numlines]' being the
+ *        size of the array.  The offset 0 is always a line start, and a
+ *        newline at the very end of the array starts no line.
+ *
+ *        The visitor, if any, is given the lines of each block as soon as
+ *        it is scanned, in order and each line once, so that a caller can
+ *        look at them while the block is still in cache rather than in a
+ *        pass of its own afterwards.
+ *
+ *        The scan uses AVX2 or SSE2 when the processor has them, as found
+ *        at run time, else it goes one character at a time.
+ *
+ *        NULL is returned on any error condition.
+ */
+
+void Deletelineindex (struct lineindex **);
+/* pre  : We are given a pointer to a pointer to a valid lineindex.
+ * post : All memory of the index is released, and the pointer is NULL.
+ */
+
+unsigned long Countnewlines (const char *, const char *);
+/* pre  : We are given two valid pointers into the same array of
+ *        characters, the first not past the second.
+ * post : Returns the number of newline characters from the first pointer
+ *        up to, but not including, the second, counted by the same scan
+ *        as Buildlineindex uses.
+ */
+
+unsigned long Lineofpointer (struct lineindex *, const char *);
+/* pre  : We are given a pointer to a valid lineindex, and a pointer into
+ *        the array it indexes.
+ * post : Returns the number, counted from 1, of the line holding the
+ *        character pointed to, found by a binary search of the index.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __SCAN_H */
+
+
+/* ********************************** END *********************************** */
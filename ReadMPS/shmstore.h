@@ -0,0 +1,117 @@
+/*
+********************************************************************************
+* FILE        : shmstore.h
+* DESCRIPTION : Header file for the shared memory store of an MPS structure
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __SHMSTORE_H
+#define __SHMSTORE_H
+
+
+
+/*
+ *******************************************************************************
+ *                               HEADER FILES                                  *
+ *******************************************************************************
+*/
+
+
+/* ************************************************************************** */
+/* *                 	      LOCAL HEADER FILES			    * */
+/* ************************************************************************** */
+
+
+#include "readmps.h"
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the permissions of a store: its publisher writes, and all may attach */
+#define STOREMODE	0644
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+/*
+ * A store is a POSIX shared memory object, named by a '/' and then no
+ * more than NAME_MAX characters with no other '/', holding the snapshot
+ * image of an MPSstruct (see snapshot.h).  The image is found by offsets
+ * from its start, so that a process attaching it has only to map it, at
+ * whatever address, and check its header; its pages are shared by every
+ * process attached.
+ */
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+int PublishMPSstore (struct MPSstruct *, char *);
+/* pre  : We are given a pointer to a valid MPSstruct, and the name of a
+ *        store.
+ * post : The store holds the snapshot image of the MPSstruct, replacing
+ *        any store of the name; processes attached to that one keep it
+ *        until they delete their MPSstruct.  The MPSstruct may then be
+ *        deleted.  Processes should attach once this has returned, as a
+ *        store being written is not whole.
+ *
+ *        Returns 1 on success, 0 on failure, which leaves no store.
+ *        Under __ANSI__C there are no stores, and 0 is returned.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+struct MPSstruct * AttachMPSstore (char *);
+/* pre  : We are given the name of a store.
+ * post : Returns an MPSstruct whose arrays point into a read-only shared
+ *        mapping of the store, taking the same time for any store.  Its
+ *        names are to be had by MPSROWNAME and MPSCOLNAME, as from any
+ *        MPSstruct, and nothing of it may be written.
+ *        DeleteMPSstruct detaches the store.
+ *
+ *        NULL is returned if there is no store of the name, or it is not
+ *        a whole image made on this machine; only the latter is reported.
+ *        Under __ANSI__C there are no stores, and NULL is returned.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int RemoveMPSstore (char *);
+/* pre  : We are given the name of a store.
+ * post : The store is removed once every process attached to it has
+ *        detached, and no process may attach it from now.  Returns 1 on
+ *        success, 0 on failure.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __SHMSTORE_H */
+
+
+/* ********************************** END *********************************** */
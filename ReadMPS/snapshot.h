@@ -0,0 +1,287 @@
+/*
+********************************************************************************
+* FILE        : snapshot.h
+* DESCRIPTION : Header file for the binary snapshot of an MPS structure
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __SNAPSHOT_H
+#define __SNAPSHOT_H
+
+
+
+/*
+ *******************************************************************************
+ *                               HEADER FILES                                  *
+ *******************************************************************************
+*/
+
+
+/* ************************************************************************** */
+/* *                 	      ANSI C HEADER FILES			    * */
+/* ************************************************************************** */
+
+
+#include <stdio.h>
+
+
+
+/* ************************************************************************** */
+/* *                 	      LOCAL HEADER FILES			    * */
+/* ************************************************************************** */
+
+
+#include "readmps.h"
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the snapshot of an MPS file is kept next to it, under its name plus this */
+#define SNAPSHOTSUFFIX		".snap"
+
+/* the first 8 characters of every snapshot, with no NULL */
+#define SNAPSHOTMAGIC		"READMPS1"
+
+/* raised whenever the layout of the image changes */
+#define SNAPSHOTVERSION		4UL
+
+/* a word whose bytes show the byte order of the machine that wrote it */
+#define SNAPSHOTBYTEORDER	0x0102030405060708ULL
+
+/* the header, and every array after it, starts on a multiple of this */
+#define SNAPSHOTALIGN		4096UL
+
+/* the bytes written out at a time */
+#define SNAPSHOTBUFFSIZE	65536UL
+
+
+/*
+ * the arrays of the image, in the order they follow the header
+ */
+
+#define SNAP_ROWNAMES		0
+#define SNAP_ROWOFFSETS		1
+#define SNAP_COLNAMES		2
+#define SNAP_COLOFFSETS		3
+#define SNAP_RELCODES		4
+#define SNAP_RHS		5
+#define SNAP_RANGES		6
+#define SNAP_UPPER		7
+#define SNAP_LOWER		8
+#define SNAP_ROWIDS		9
+#define SNAP_VALUES		10
+#define SNAP_COLSTARTS		11
+#define SNAP_ROWBITS		12
+#define SNAP_ROWRANKS		13
+#define SNAP_ROWLOOKUP		14
+#define SNAP_COLBITS		15
+#define SNAP_COLRANKS		16
+#define SNAP_COLLOOKUP		17
+#define SNAPSHOTARRAYS		18
+
+
+/* the outcome of CheckMPSsnapshot */
+
+#define SNAPSHOT_OK		1
+#define SNAPSHOT_FOREIGN	0
+#define SNAPSHOT_DAMAGED	-1
+
+
+
+/*
+ *******************************************************************************
+ *                      	STRUCTURES				       *
+ *******************************************************************************
+*/
+
+
+/*
+ * what stat tells of a file, to know it unchanged without reading it; the
+ * times are to the nanosecond, as a file may be written again, at the
+ * same size, within a second
+ */
+struct sourcekey {
+   unsigned long      size;       /* its size in bytes                  */
+   unsigned long long inode;      /* its inode, new if it was replaced  */
+   long               mtime,      /* its last modification, in seconds  */
+                      mtimensec,  /*   and nanoseconds                  */
+                      ctime,      /* its last change of status          */
+                      ctimensec;  /*   and nanoseconds                  */
+};
+
+
+/* the first page of a snapshot image */
+struct snapshotheader {
+   char               magic[8];      /* SNAPSHOTMAGIC                      */
+   unsigned long      version;       /* SNAPSHOTVERSION                    */
+   unsigned long long byteorder;     /* SNAPSHOTBYTEORDER as written       */
+   unsigned long      longsize,      /* sizeof (long) of the writer        */
+                      indexsize,     /* sizeof (kernelindex) of the writer */
+                      imagesize;     /* bytes of the whole image           */
+
+   /* the MPS file the image was made from */
+   struct sourcekey   source;        /* its size, inode and times          */
+   unsigned long long sourcehash;    /* hashblock of its contents          */
+   long               sourceformat;  /* the MPSFORMAT_ it was read in      */
+
+   /* the scalar fields of the MPSstruct */
+   long               numberrows,
+                      numbercols;
+   unsigned long      numberelements,
+                      numberzeroelements,
+                      rownamesize,
+                      colnamesize;
+   char               lpname[MAX_LPNAMESIZE],
+                      rhsname[MAX_FREENAMESIZE],
+                      ranname[MAX_FREENAMESIZE],
+                      bndname[MAX_FREENAMESIZE];
+
+   /* the sizes of the name lookups, whose arrays are in the image */
+   struct perfectshape rowshape,
+                       colshape;
+
+   /* where each SNAP_ array starts in the image */
+   unsigned long      offsets[SNAPSHOTARRAYS];
+
+   unsigned long long payloadsum,    /* hashblock of all after the header  */
+                      headersum;     /* hashblock of the header, this 0    */
+};
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+unsigned long SizeMPSsnapshot (struct MPSstruct *);
+/* pre  : We are given a pointer to a valid MPSstruct.
+ * post : Returns the size in bytes of its snapshot image.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int WriteMPSsnapshot (struct MPSstruct *, char *, FILE *, char *);
+/* pre  : We are given a pointer to a valid MPSstruct, the name of the MPS
+ *        file it was read from or NULL, and either a binary file open for
+ *        writing or, with the file NULL, SizeMPSsnapshot bytes of memory.
+ * post : Writes the snapshot image of the MPSstruct, from the start of the
+ *        file or the memory: a header page, then the name tables, the rim
+ *        vectors and the kernel arrays, each on a page of its own, all of
+ *        them checksummed; the values of a packed kernel are written
+ *        whole.  The header, written last, records the size, inode, times
+ *        of last modification and change, and a hash of the contents of
+ *        the MPS file if there is one, so that a stale image is known.
+ *
+ *        Returns 1 on success, 0 on failure.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int CheckMPSsnapshot (char *, unsigned long, int, struct snapshotheader *);
+/* pre  : We are given a snapshot image, its size, 1 if the checksum of
+ *        all after the header is to be checked else 0, and a pointer to a
+ *        snapshot header.
+ * post : The header of the image is copied to the one given.  Returns
+ *        SNAPSHOT_OK if the image is whole, SNAPSHOT_FOREIGN if it was
+ *        made on a machine of another word size or byte order, or by
+ *        another version, and SNAPSHOT_DAMAGED otherwise.  Without the
+ *        payload, the check takes the same time for any image.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+struct MPSstruct * OpenMPSsnapshot (char *, unsigned long,
+                                     struct snapshotheader *);
+/* pre  : We are given a snapshot image, its size, and its header, as
+ *        passed by CheckMPSsnapshot.
+ * post : Returns an MPSstruct whose arrays, its name pools and offsets
+ *        among them, point into the image.  DeleteMPSstruct
+ *        releases the image, with Releasefilememory, and the structure.
+ *        NULL is returned if there is no memory for the structure.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int SaveMPSsnapshot (struct MPSstruct *, char *, char *);
+/* pre  : We are given a pointer to a valid MPSstruct, the name of the MPS
+ *        file it was read from, and the name of the snapshot to write.
+ * post : Writes the snapshot image of the MPSstruct, as WriteMPSsnapshot.
+ *
+ *        The image is written under a temporary name, unique to the
+ *        writer and beside the snapshot, and then renamed, so that a
+ *        reader never sees half of one and two writers never mix theirs.
+ *
+ *        Returns 1 on success, 0 on failure, which leaves no snapshot.
+ *        Under __ANSI__C there are no snapshots, and 0 is returned.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+struct MPSstruct * LoadMPSsnapshot (char *, char *);
+/* pre  : We are given the name of a snapshot, and the name of the MPS
+ *        file it should be the image of.
+ * post : Returns an MPSstruct on a private mapping of the snapshot, its
+ *        arrays pointing into the image with no pointer set up afresh;
+ *        DeleteMPSstruct releases the mapping with the rest.
+ *
+ *        NULL is returned if the snapshot is missing, damaged, made on a
+ *        machine of another word size or byte order, or stale.  It is
+ *        stale unless the MPS file has the size recorded, was read in
+ *        the format now set, and either has the inode and times recorded,
+ *        last modified strictly before the snapshot was written, or else
+ *        has the hash of its contents recorded.  Only a damaged snapshot
+ *        is reported.  When the contents had to be hashed, and matched,
+ *        the inode and times are recorded again in the header of the
+ *        snapshot, so that only the first load after a touch hashes the
+ *        MPS file.
+ *        Under __ANSI__C there are no snapshots, and NULL is returned.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+struct MPSstruct * GetMPSdatacached (char *);
+/* pre  : We are given a valid pointer to a string of characters.
+ * post : As GetMPSdata, but an up-to-date snapshot of the MPS file, of
+ *        its name plus SNAPSHOTSUFFIX, is loaded in its place when there
+ *        is one.  Otherwise the MPS file is read, and the snapshot made
+ *        for the next time; should that fail, the MPS data is returned
+ *        all the same.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __SNAPSHOT_H */
+
+
+/* ********************************** END *********************************** */
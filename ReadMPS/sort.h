@@ -36,6 +36,27 @@
 
 
 
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* below this many elements rowsort uses an insertion sort */
+#define SMALLSORTSIZE	32L
+
+/* the bits of a row id taken by each pass of the radix sort in rowsort */
+#define RADIXBITS	8
+#define RADIXSIZE	(1L << RADIXBITS)
+
+/* the way rowsort put an array in order */
+#define SORT_ORDERED	0
+#define SORT_INSERTION	1
+#define SORT_RADIX	2
+
+
+
 /*
  *******************************************************************************
  *                               PROTOTYPES                                    *
@@ -54,6 +75,25 @@ void heapsort (long **, long);
  *        element defined by the provided long.  The order is ascending.
  */
 
+#ifndef __C__PLUS__PLUS
+extern 
+#endif
+int rowsort (long **, long **, long, long);
+/* pre  : We are given two valid pointers to long pointers, each array
+ *        holding at least as many items as the first long, and a second
+ *        long greater than every item of the first array, none of which
+ *        is negative.
+ * post : The first array is sorted into ascending order in time linear
+ *        in its items, the second being used as scratch.  An array found
+ *        to be in order already is left at once, and a short one is put
+ *        in order by insertion; otherwise a radix sort of RADIXBITS bits
+ *        a pass is made, with as few passes as the second long needs,
+ *        and the two pointers may be exchanged.
+ *
+ *        Returns SORT_ORDERED, SORT_INSERTION or SORT_RADIX, for the way
+ *        the array was put in order.
+ */
+
 #ifdef __C__PLUS__PLUS
 }
 #endif /* __C__PLUS__PLUS */
@@ -28,6 +28,7 @@
 #include <time.h>
 #ifndef __ANSI__C
 #include <sys/times.h>
+#include <sys/resource.h>
 #ifndef CLK_TCK
 #include <unistd.h>
 #define CLK_TCK    sysconf(_SC_CLK_TCK)
@@ -49,6 +50,18 @@
 #define TIMESTRUCTURE struct tms
 #endif /* __ANSI__C */
 
+#ifdef __ANSI__C
+#define MEMORYSTRUCTURE long
+#else
+#define MEMORYSTRUCTURE struct rusage
+#endif /* __ANSI__C */
+
+#ifdef __ANSI__C
+#define WALLSTRUCTURE clock_t
+#else
+#define WALLSTRUCTURE struct timespec
+#endif /* __ANSI__C */
+
 
 
 /*
@@ -81,6 +94,48 @@
  */
 #endif /* __ANSI__C */
 
+#ifdef __ANSI__C
+#define getmemorydata(ru_ptr)   (*(ru_ptr) = 0L)
+#else
+#define getmemorydata(ru_ptr)   ((void)getrusage(RUSAGE_SELF, (ru_ptr)))
+/* pre  : We are given a valid pointer to "struct rusage".
+ * post : Sets up the resource usage data for "ru_ptr".
+ */
+#endif /* __ANSI__C */
+
+#ifdef __ANSI__C
+#define getpeakrss(mem)   (mem)
+#else
+#define getpeakrss(mem)   ((long)(mem).ru_maxrss)
+/* pre  : We are given a valid "rusage" structure.
+ * post : Returns the peak resident set size of the process in kilobytes,
+ *        or zero where the system cannot tell us.
+ */
+#endif /* __ANSI__C */
+
+#ifdef __ANSI__C
+#define getwalldata(wall_ptr)   (*(wall_ptr) = clock ())
+#else
+#define getwalldata(wall_ptr)   ((void)clock_gettime(CLOCK_MONOTONIC, (wall_ptr)))
+/* pre  : We are given a valid pointer to "struct timespec".
+ * post : Sets up the monotonic clock reading for "wall_ptr".
+ */
+#endif /* __ANSI__C */
+
+#ifdef __ANSI__C
+#define getwalltime(start,end)   \
+       ((double)((end) - (start)) / (double)CLOCKS_PER_SEC)
+#else
+#define getwalltime(start,end)  \
+        ((double)((end).tv_sec - (start).tv_sec) + \
+	 (double)((end).tv_nsec - (start).tv_nsec) / 1.0e9)
+/* pre  : We are given two valid "timespec" structures.
+ * post : Returns the elapsed time in seconds between the first argument
+ *        and the second, to the nanosecond; under __ANSI__C, where there
+ *        is no monotonic clock, the processor time is given instead.
+ */
+#endif /* __ANSI__C */
+
 
 
 /* ************************************************************************** */
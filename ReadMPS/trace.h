@@ -0,0 +1,215 @@
+/*
+********************************************************************************
+* FILE        : trace.h
+* DESCRIPTION : Header file for the trace of events of a load
+* AUTHOR      : M H Khaliq
+* LICENSE     : MIT
+********************************************************************************
+*/
+
+
+
+#ifndef __TRACE_H
+#define __TRACE_H
+
+
+
+/*
+ *******************************************************************************
+ *                                  MACROS                                     *
+ *******************************************************************************
+*/
+
+
+/*
+ * The trace is only made under __TRACE__MPS; otherwise the macros below
+ * are empty, and cost nothing.  Each event is a string literal for its
+ * name, a time and a number, put in a ring of the thread that made it and
+ * only turned into text once the trace is written.  A mark is the time a
+ * span began, declared by TRACEMARK at the end of the declarations of a
+ * function, with no semicolon after it.
+ */
+
+#ifdef __TRACE__MPS
+
+#define TRACEMARK(mark)		long long mark;
+/* post : Declares the mark of a span. */
+
+#define TRACESTART(mark)	((mark) = Tracenow ())
+/* post : The span of the mark begins now. */
+
+#define TRACEPHASE(name,mark)	(Tracephase ((name), &(mark)))
+/* post : A span of the name, from the mark to now, is kept apart from the
+ *        ring of the thread, so that it is never overwritten; the next
+ *        span of the mark begins now.  This is for the few, long phases
+ *        of a load.
+ */
+
+#define TRACESPAN(name,mark)	(Traceevent ((name), 'X', (mark), \
+				              Tracenow () - (mark)))
+/* post : A span of the name, from the mark to now, is put in the ring. */
+
+#define TRACEEVENT(name,value)	(Traceevent ((name), 'i', Tracenow (), \
+				              (long long) (value)))
+/* post : An instant of the name, with the value, is put in the ring. */
+
+#define TRACECOUNT(name,value)	(Traceevent ((name), 'C', Tracenow (), \
+				              (long long) (value)))
+/* post : The counter of the name is set to the value from now. */
+
+#else
+
+#define TRACEMARK(mark)
+#define TRACESTART(mark)
+#define TRACEPHASE(name,mark)
+#define TRACESPAN(name,mark)
+#define TRACEEVENT(name,value)
+#define TRACECOUNT(name,value)
+
+#endif /* __TRACE__MPS */
+
+
+/* ************************************************************************** */
+/* *                            END OF MACROS                               * */
+/* ************************************************************************** */
+
+
+
+/*
+ *******************************************************************************
+ *                                 DEFINES                                     *
+ *******************************************************************************
+*/
+
+
+/* the events of the ring of a thread, a power of 2; older ones are lost */
+#define TRACEBUFFERSIZE		(1L << 16)
+
+/* the spans of TRACEPHASE kept for a thread; any more are lost */
+#define TRACEPHASES		256L
+
+/*
+ * the most threads traced at once; the events of any more are lost.  A
+ * thread that ends gives its ring to the next thread to be traced
+ */
+#define MAXTRACETHREADS		64L
+
+/* the environment variable naming the file the driver traces to */
+#define TRACEVARIABLE		"READMPS_TRACE"
+
+
+
+/*
+ *******************************************************************************
+ *                      	STRUCTURES				       *
+ *******************************************************************************
+*/
+
+
+/* one event of a trace */
+struct traceevent {
+   const char *name;   /* a string literal                           */
+   long long  time,    /* nanoseconds from the start of the trace    */
+              value;   /* the nanoseconds of a span, else its number */
+   char       phase;   /* 'X' for a span, 'i' instant, 'C' counter   */
+};
+
+
+/* the events of one track, only ever written by the thread holding it */
+struct tracebuffer {
+   struct traceevent ring[TRACEBUFFERSIZE],  /* the latest events     */
+                     phases[TRACEPHASES];    /* the spans of phases   */
+   unsigned long     numevents,  /* the events ever put in the ring   */
+                     numphases,  /* the spans of phases ever made     */
+                     tid;        /* the track, from 1 in its order    */
+};
+
+
+
+/*
+ *******************************************************************************
+ *                               PROTOTYPES                                    *
+ *******************************************************************************
+*/
+
+
+/*
+ * A program calls only Starttrace and Writetrace; the rest are reached
+ * through the macros above.  Under __TRACE__MPS the driver traces its load
+ * to the file named by TRACEVARIABLE, if it is set.  The trace is in the
+ * JSON of the Chrome trace viewer, which Perfetto reads too, with a track
+ * for each thread.
+ */
+
+#ifdef __C__PLUS__PLUS
+extern "C" {
+#else
+extern
+#endif /* __C__PLUS__PLUS */
+int Starttrace (const char *);
+/* pre  : We are given the name of a file.
+ * post : Events are traced from now, with times from now, and the trace
+ *        is written to the file when the program exits, or before by
+ *        Writetrace.  A trace started already is begun again, to the new
+ *        file.
+ *
+ *        Returns 1 on success, 0 on failure.  Without __TRACE__MPS there
+ *        is no trace, and 0 is returned.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+int Writetrace (void);
+/* pre  : None.
+ * post : The events of every thread traced so far are written to the file
+ *        of the trace, replacing whatever it held, and tracing goes on.
+ *        The threads are to have stopped making events, as their rings
+ *        are read without a lock.  Events lost to a full ring, or to too
+ *        many threads at once, are counted in the "otherData" of the
+ *        trace.  The threads that held a ring in turn share its track.
+ *
+ *        Returns 1 on success, 0 on failure or if no trace was started.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+long long Tracenow (void);
+/* pre  : None.
+ * post : Returns the nanoseconds since the trace was started.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+void Traceevent (const char *, char, long long, long long);
+/* pre  : We are given a string literal, the phase of an event, and its
+ *        time and value, as in a traceevent.
+ * post : Puts the event in the ring of the calling thread, if a trace is
+ *        started, overwriting the oldest event of a full ring.
+ */
+
+#ifndef __C__PLUS__PLUS
+extern
+#endif
+void Tracephase (const char *, long long *);
+/* pre  : We are given a string literal, and a pointer to a mark.
+ * post : Keeps the span of the name from the mark to now for the calling
+ *        thread, if a trace is started and there is room, and sets the
+ *        mark to now.
+ */
+#ifdef __C__PLUS__PLUS
+}
+#endif /* __C__PLUS__PLUS */
+
+
+/* ************************************************************************** */
+/* *	                     END OF PROTOTYPES			            * */
+/* ************************************************************************** */
+
+
+#endif /* __TRACE_H */
+
+
+/* ********************************** END *********************************** */